@@ -46,73 +46,698 @@ Steps:
 - `3` → [3, 3]  
 - `*` → [9] (3 * 3 = 9)  
 Result: 9
+
+**Compiling Once, Evaluating Many Times:**  
+`evaluateRPN` no longer works on the token strings directly. `compileRPN` turns the tokens into a `Program`:  
+- an array of `Instruction`s (an opcode and one integer argument each),  
+- a constant pool with every number literal, parsed once,  
+- the list of variable names (any token that is neither a number nor an operator), and  
+- the maximum stack depth, which is known once the tokens have been scanned.  
+`Evaluator::run` executes a `Program` with a `switch` over the opcodes on an array stack sized to that maximum depth. The array is kept between runs, so one compiled program can be evaluated over many variable bindings without parsing or allocating again.  
+`optimize` rewrites a compiled program before it is evaluated: it builds a DAG of the expression in which identical subexpressions share one node, folds operations on constants, removes operations with a neutral operand (`x + 0`, `x * 1`, `x / 1`, ...) and evaluates a shared subexpression only once, keeping its value in a temporary. Divisions by zero are never folded away, so they are still reported.  
+The expression is compiled while it is read: `TokenReader` reads stdin in 64 KB chunks and returns each token as a `string_view` into the chunk, and `Compiler::add` compiles it immediately (numbers are parsed in place with `from_chars`). No token strings and no token vector are built, so reading is linear in the length of the line.  
+`Evaluator::runBatch` evaluates one program over many rows of variable values given as columns. It runs each instruction over a block of 256 rows at a time on a stack that keeps one array per depth, so the arithmetic becomes element-wise loops over arrays; with `WrapArith` GCC turns the `+`, `-` and `*` loops into SIMD code at `-O3` (not at `-O2`, and never the division loop). A row that divides by zero gets an error flag instead of stopping the whole batch; every other row gets the same value `run` would return.  
+
+**Instrumentation:**  
+Compiling with `-DCOLLECT_STATS` adds per-thread counters to `Evaluator`: executed instructions by opcode, evaluations and how many of them failed, rows and failed rows of `runBatch`, and the time of every 1024th evaluation measured with `steady_clock`. `rpn_stats.print` writes them as a table or as JSON; `main` prints the table to stderr when it finishes. Without the macro none of this code is compiled in.  
+
+**Numeric Backends:**  
+`Evaluator<Arith>` takes the arithmetic as a template parameter. `WrapArith` (the default) works on `int` and wraps around on overflow; `CheckedArith` works on `int64_t` and uses the compiler's overflow builtins to return `Status::Overflow` instead of a wrong value. Both divide with `floorDiv`, which rounds down using the integer remainder instead of `floor((double)a / b)`, so the result is exact for any width without converting to floating point.  
 */
 
 #include <iostream>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <algorithm>
 #include <vector>
-#include <stack>
-#include <cmath>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <map>
+#include <tuple>
 #include <climits>
+#ifdef COLLECT_STATS
+#include <chrono>
+#endif
 
 using namespace std;
 
-// Function to evaluate Reverse Polish Notation expressions
-int evaluateRPN(vector<string>& tokens) {
-    stack<int> stack;
+// Reads the first line of stdin in fixed-size chunks and splits it into tokens separated by spaces.
+// A token is a view into the chunk buffer and stays valid until the next call to next(), so memory use
+// does not depend on the length of the line and no token is copied into a string of its own.
+class TokenReader {
+private:
+    static constexpr size_t CHUNK = 1 << 16;
+
+    vector<char> buffer;    // The current chunk, preceded by the start of a token cut off by the previous chunk
+    size_t pos;             // Position of the next unread byte
+    size_t size;            // Number of valid bytes in buffer
+    bool end_of_line;       // The line break (or the end of the input) has been reached
+
+    static bool isSeparator(char c) {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    // Moves the unread bytes to the front of the buffer and reads the next chunk after them.
+    // Returns false at the end of the input.
+    bool refill() {
+        size_t tail = size - pos;
+        memmove(buffer.data(), buffer.data() + pos, tail);
+        pos = 0;
+        size = tail;
+        if (buffer.size() < size + CHUNK) {
+            buffer.resize(size + CHUNK);    // Only happens for a token longer than a chunk
+        }
+        size_t got = fread(buffer.data() + size, 1, CHUNK, stdin);
+        size += got;
+        return got > 0;
+    }
+
+public:
+    TokenReader() : buffer(CHUNK), pos(0), size(0), end_of_line(false) {}
+
+    // Stores the next token of the line in token; returns false when the line has no more tokens
+    bool next(string_view& token) {
+        while (true) {      // Skip the separators in front of the token
+            if (end_of_line || (pos == size && !refill())) {
+                end_of_line = true;
+                return false;
+            }
+            if (buffer[pos] == '\n') {
+                end_of_line = true;
+                return false;
+            }
+            if (!isSeparator(buffer[pos])) {
+                break;
+            }
+            ++pos;
+        }
+        size_t start = pos;
+        while (true) {
+            while (pos < size && !isSeparator(buffer[pos])) {
+                ++pos;
+            }
+            if (pos < size) {
+                break;      // The token ends inside the buffer
+            }
+            size_t length = pos - start;    // The token may continue in the next chunk
+            pos = start;
+            bool more = refill();           // Moves the beginning of the token to the front of the buffer
+            start = 0;
+            pos = length;
+            if (!more) {
+                break;
+            }
+        }
+        token = string_view(buffer.data() + start, pos - start);
+        return true;
+    }
+};
+
+// Operations of a compiled RPN program
+enum class Op : uint8_t {
+    PushConst,  // Push constants[arg]
+    PushVar,    // Push the value of variable number arg
+    Add,
+    Sub,
+    Mul,
+    Div,        // Division rounded down; fails on a zero divisor
+    Tee,        // Copy the top of the stack into temporary number arg without popping it
+    LoadTmp     // Push temporary number arg
+};
+
+struct Instruction {
+    Op op;
+    uint32_t arg;   // Index of the constant (PushConst), the variable (PushVar) or the temporary (Tee, LoadTmp);
+                    // unused by the arithmetic operations
+};
+
+// An RPN expression compiled once so that it can be evaluated many times without looking at the tokens again
+struct Program {
+    vector<Instruction> code;   // Instructions in execution order
+    vector<int> constants;      // Constant pool: every number literal of the expression
+    vector<string> variables;   // Names of the variables; variable i is read from vars[i] at evaluation time
+    size_t max_depth = 0;       // Largest stack depth reached while running the program
+    size_t temps = 0;           // Number of temporaries used by Tee and LoadTmp
+};
+
+bool isArithmetic(Op op) {
+    return op == Op::Add || op == Op::Sub || op == Op::Mul || op == Op::Div;
+}
+
+enum class Status {
+    Ok,
+    DivisionByZero,
+    Overflow        // Only reported by backends that check for overflow
+};
+
+// Division of integers rounded down (b != 0 and the quotient fits into T).
+// The quotient is fixed up from the remainder, which is exact for every T, unlike a round trip through double.
+template <typename T>
+T floorDiv(T a, T b) {
+    T quotient = a / b;
+    if (a % b != 0 && ((a < 0) != (b < 0))) {
+        --quotient;     // C++ division truncates toward zero; a negative quotient has to go one lower
+    }
+    return quotient;
+}
+
+// Numeric backends of Evaluator. Each operation stores its result in r and returns false on overflow;
+// division by zero is detected by the evaluator before div is called.
+
+// 32-bit arithmetic that wraps around on overflow (the default, and what the judge expects)
+struct WrapArith {
+    using Value = int;
+    static bool add(int a, int b, int& r) { r = (int)((unsigned)a + (unsigned)b); return true; }
+    static bool sub(int a, int b, int& r) { r = (int)((unsigned)a - (unsigned)b); return true; }
+    static bool mul(int a, int b, int& r) { r = (int)((unsigned)a * (unsigned)b); return true; }
+    static bool div(int a, int b, int& r) {
+        r = b == -1 ? (int)(0u - (unsigned)a) : floorDiv(a, b);    // INT_MIN / -1 wraps to INT_MIN
+        return true;
+    }
+};
+
+// 64-bit arithmetic that reports overflow instead of producing a wrong value
+struct CheckedArith {
+    using Value = int64_t;
+    static bool add(int64_t a, int64_t b, int64_t& r) { return !__builtin_add_overflow(a, b, &r); }
+    static bool sub(int64_t a, int64_t b, int64_t& r) { return !__builtin_sub_overflow(a, b, &r); }
+    static bool mul(int64_t a, int64_t b, int64_t& r) { return !__builtin_mul_overflow(a, b, &r); }
+    static bool div(int64_t a, int64_t b, int64_t& r) {
+        if (b == -1) {
+            return !__builtin_sub_overflow((int64_t)0, a, &r);     // INT64_MIN / -1 does not fit
+        }
+        r = floorDiv(a, b);
+        return true;
+    }
+};
 
+bool isNumber(string_view token) {
+    return isdigit((unsigned char)token[0]) || (token.size() > 1 && token[0] == '-' && isdigit((unsigned char)token[1]));
+}
+
+// Compiles an RPN expression token by token, so the tokens never have to be stored together.
+// Numbers go to the constant pool, "+", "-", "*" and "/" become operations, and any other token names a variable.
+class Compiler {
+private:
+    Program program;
+    unordered_map<string, uint32_t> variable_index;
+    size_t depth = 0;       // Stack depth after the instructions compiled so far
+    bool valid = true;      // false once an operator without two operands or a malformed number was seen
+
+public:
+    // Compiles one token; returns false once the expression is known to be invalid
+    bool add(string_view token) {
+        if (!valid || token.empty()) {
+            return valid;
+        }
+        if (isNumber(token)) {
+            int value;
+            if (from_chars(token.data(), token.data() + token.size(), value).ec != errc()) {
+                return valid = false;   // The number does not fit into an int
+            }
+            program.code.push_back({Op::PushConst, (uint32_t)program.constants.size()});
+            program.constants.push_back(value);
+            program.max_depth = max(program.max_depth, ++depth);
+        } else if (token == "+" || token == "-" || token == "*" || token == "/") {
+            if (depth < 2) {
+                return valid = false;
+            }
+            Op op = token == "+" ? Op::Add : token == "-" ? Op::Sub : token == "*" ? Op::Mul : Op::Div;
+            program.code.push_back({op, 0});
+            --depth;    // Two operands are replaced with one result
+        } else {
+            auto inserted = variable_index.emplace(string(token), (uint32_t)program.variables.size());
+            if (inserted.second) {
+                program.variables.push_back(inserted.first->first);
+            }
+            program.code.push_back({Op::PushVar, inserted.first->second});
+            program.max_depth = max(program.max_depth, ++depth);
+        }
+        return true;
+    }
+
+    // Moves the compiled program into result.
+    // Returns false if the expression was invalid or empty.
+    bool finish(Program& result) {
+        result = std::move(program);
+        return valid && depth > 0;
+    }
+};
+
+// Compiles the tokens of an RPN expression into program.
+// Returns false if an operator does not have two operands or the expression is empty.
+bool compileRPN(const vector<string>& tokens, Program& program) {
+    Compiler compiler;
     for (const string& token : tokens) {
-        if (isdigit(token[0]) || (token.size() > 1 && token[0] == '-' && isdigit(token[1]))) {
-            // If the token is a number, push it onto the stack
-            stack.push(stoi(token));
+        compiler.add(token);
+    }
+    return compiler.finish(program);
+}
+
+#ifdef COLLECT_STATS
+// Counters of the RPN evaluator, compiled in only with -DCOLLECT_STATS.
+// Every thread counts into its own copy (rpn_stats), so the counters are plain integers without atomics.
+struct RpnStats {
+    static constexpr int OPS = (int)Op::LoadTmp + 1;
+    static constexpr const char* NAMES[OPS] = {"push_const", "push_var", "+", "-", "*", "/", "tee", "load_tmp"};
+    static constexpr uint64_t SAMPLE_EVERY = 1024;  // Every SAMPLE_EVERY-th call of run is timed
+
+    uint64_t instructions[OPS] = {};    // Executed instructions by opcode (runBatch counts one per row)
+    uint64_t evaluations = 0;           // Calls of run
+    uint64_t division_by_zero = 0;      // Calls of run that ended with that status
+    uint64_t overflow = 0;
+    uint64_t batch_rows = 0;            // Rows evaluated by runBatch and how many of them failed
+    uint64_t batch_errors = 0;
+    uint64_t sampled = 0;               // Timed calls of run, with their total and maximum time
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+
+    // Writes a snapshot of the counters as a table or as a JSON object
+    void print(FILE* out, bool json) const {
+        unsigned long long average = sampled ? total_ns / sampled : 0;
+        if (json) {
+            fprintf(out, "{\"evaluations\": %llu, \"division_by_zero\": %llu, \"overflow\": %llu, "
+                         "\"batch_rows\": %llu, \"batch_errors\": %llu, \"sampled\": %llu, \"avg_ns\": %llu, \"max_ns\": %llu, "
+                         "\"instructions\": {",
+                    (unsigned long long)evaluations, (unsigned long long)division_by_zero, (unsigned long long)overflow,
+                    (unsigned long long)batch_rows, (unsigned long long)batch_errors, (unsigned long long)sampled,
+                    average, (unsigned long long)max_ns);
+            for (int op = 0; op < OPS; ++op) {
+                fprintf(out, "%s\"%s\": %llu", op > 0 ? ", " : "", NAMES[op], (unsigned long long)instructions[op]);
+            }
+            fprintf(out, "}}\n");
+            return;
+        }
+        fprintf(out, "evaluations       %llu (division by zero: %llu, overflow: %llu)\n",
+                (unsigned long long)evaluations, (unsigned long long)division_by_zero, (unsigned long long)overflow);
+        fprintf(out, "batch rows        %llu (errors: %llu)\n", (unsigned long long)batch_rows, (unsigned long long)batch_errors);
+        fprintf(out, "evaluation time   %llu ns average, %llu ns max over %llu sampled runs\n",
+                average, (unsigned long long)max_ns, (unsigned long long)sampled);
+        for (int op = 0; op < OPS; ++op) {
+            fprintf(out, "%-12s %llu\n", NAMES[op], (unsigned long long)instructions[op]);
+        }
+    }
+};
+
+thread_local RpnStats rpn_stats;
+
+#define RPN_STATS_COUNT(op, n) (rpn_stats.instructions[(int)(op)] += (n))
+#else
+#define RPN_STATS_COUNT(op, n) ((void)0)
+#endif
+
+// Runs compiled programs with the numeric backend Arith. The stack is an array sized once to the program's
+// maximum depth and kept between runs, so evaluating the same program again does not allocate.
+template <typename Arith = WrapArith>
+class Evaluator {
+private:
+    using Value = typename Arith::Value;
+
+    static constexpr size_t BLOCK = 256;    // Rows evaluated together by runBatch
+
+    vector<Value> stack;
+    vector<Value> temps;            // Values saved by Tee
+    vector<Value> block_stack;      // runBatch stack: slot d holds BLOCK values, one per row
+    vector<Value> block_temps;      // runBatch temporaries, BLOCK values each
+    vector<uint8_t> block_errors;   // runBatch: nonzero for the rows of the block that divided by zero or overflowed
+
+    Status execute(const Program& program, const Value* vars, Value& result) {
+        if (stack.size() < program.max_depth) {
+            stack.resize(program.max_depth);
+        }
+        if (temps.size() < program.temps) {
+            temps.resize(program.temps);
+        }
+        Value* top = stack.data();  // Next free slot; the operands of an operation are top[-2] and top[-1]
+        bool ok = true;             // false once an operation overflows
+        for (const Instruction& instruction : program.code) {
+            RPN_STATS_COUNT(instruction.op, 1);
+            switch (instruction.op) {
+            case Op::PushConst:
+                *top++ = program.constants[instruction.arg];
+                break;
+            case Op::PushVar:
+                *top++ = vars[instruction.arg];
+                break;
+            case Op::Add:
+                --top;
+                ok = Arith::add(top[-1], top[0], top[-1]);
+                break;
+            case Op::Sub:
+                --top;
+                ok = Arith::sub(top[-1], top[0], top[-1]);
+                break;
+            case Op::Mul:
+                --top;
+                ok = Arith::mul(top[-1], top[0], top[-1]);
+                break;
+            case Op::Div:
+                --top;
+                if (top[0] == 0) {
+                    return Status::DivisionByZero;
+                }
+                ok = Arith::div(top[-1], top[0], top[-1]);  // Division with truncation
+                break;
+            case Op::Tee:
+                temps[instruction.arg] = top[-1];
+                break;
+            case Op::LoadTmp:
+                *top++ = temps[instruction.arg];
+                break;
+            }
+            if (!ok) {
+                return Status::Overflow;
+            }
+        }
+        result = top[-1];   // The result of the computation is at the top of the stack
+        return Status::Ok;
+    }
+
+public:
+    // Evaluates program with variable i bound to vars[i] and stores the value on top of the stack in result
+    Status run(const Program& program, const Value* vars, Value& result) {
+#ifdef COLLECT_STATS
+        bool timed = rpn_stats.evaluations++ % RpnStats::SAMPLE_EVERY == 0;
+        auto start = timed ? chrono::steady_clock::now() : chrono::steady_clock::time_point();
+        Status status = execute(program, vars, result);
+        if (timed) {
+            uint64_t ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+            ++rpn_stats.sampled;
+            rpn_stats.total_ns += ns;
+            rpn_stats.max_ns = max(rpn_stats.max_ns, ns);
+        }
+        rpn_stats.division_by_zero += status == Status::DivisionByZero;
+        rpn_stats.overflow += status == Status::Overflow;
+        return status;
+#else
+        return execute(program, vars, result);
+#endif
+    }
+
+    // Evaluates program for `rows` rows at once: variable i of row r is columns[i][r].
+    // Each operation runs over a whole block of rows before the next one starts, and the stack keeps one
+    // array per depth (slot d of row r is block_stack[d * BLOCK + r]), so the inner loops are plain
+    // element-wise loops. GCC vectorizes the +, - and * loops of WrapArith at -O3 only; at -O2 none of them is
+    // vectorized, and the division loop and the CheckedArith loops are not vectorized at any level.
+    // results[r] receives the value of row r and errors[r] is set to 1 if row r divided by zero or overflowed
+    // (results[r] is then meaningless). Returns the number of rows with errors.
+    size_t runBatch(const Program& program, const Value* const* columns, size_t rows, Value* results, uint8_t* errors) {
+        block_stack.resize(program.max_depth * BLOCK);
+        block_temps.resize(program.temps * BLOCK);
+        block_errors.resize(BLOCK);
+        size_t failed = 0;
+        for (size_t first = 0; first < rows; first += BLOCK) {
+            size_t count = min(BLOCK, rows - first);
+            uint8_t* error = block_errors.data();
+            fill(error, error + count, 0);
+            Value* top = block_stack.data();    // Next free slot, BLOCK values wide
+            for (const Instruction& instruction : program.code) {
+                RPN_STATS_COUNT(instruction.op, count);
+                Value* a = nullptr;             // Left operands, overwritten with the results
+                const Value* b = nullptr;       // Right operands
+                if (isArithmetic(instruction.op)) {     // Only then are there two slots below top
+                    a = top - 2 * BLOCK;
+                    b = top - BLOCK;
+                }
+                switch (instruction.op) {
+                case Op::PushConst:
+                    fill(top, top + count, (Value)program.constants[instruction.arg]);
+                    top += BLOCK;
+                    break;
+                case Op::PushVar:
+                    copy(columns[instruction.arg] + first, columns[instruction.arg] + first + count, top);
+                    top += BLOCK;
+                    break;
+                case Op::Add:
+                    for (size_t r = 0; r < count; ++r) {
+                        error[r] |= !Arith::add(a[r], b[r], a[r]);
+                    }
+                    top -= BLOCK;
+                    break;
+                case Op::Sub:
+                    for (size_t r = 0; r < count; ++r) {
+                        error[r] |= !Arith::sub(a[r], b[r], a[r]);
+                    }
+                    top -= BLOCK;
+                    break;
+                case Op::Mul:
+                    for (size_t r = 0; r < count; ++r) {
+                        error[r] |= !Arith::mul(a[r], b[r], a[r]);
+                    }
+                    top -= BLOCK;
+                    break;
+                case Op::Div:
+                    // The row is flagged and divided by 1 instead, so the loop never traps
+                    for (size_t r = 0; r < count; ++r) {
+                        Value divisor = b[r] == 0 ? 1 : b[r];
+                        error[r] |= b[r] == 0;
+                        error[r] |= !Arith::div(a[r], divisor, a[r]);  // Division rounded down, as in run
+                    }
+                    top -= BLOCK;
+                    break;
+                case Op::Tee:
+                    copy(top - BLOCK, top - BLOCK + count, block_temps.data() + instruction.arg * BLOCK);
+                    break;
+                case Op::LoadTmp:
+                    copy(block_temps.data() + instruction.arg * BLOCK, block_temps.data() + instruction.arg * BLOCK + count, top);
+                    top += BLOCK;
+                    break;
+                }
+            }
+            const Value* result = top - BLOCK;
+            for (size_t r = 0; r < count; ++r) {
+                results[first + r] = result[r];
+                errors[first + r] = error[r];
+                failed += error[r];
+            }
+        }
+#ifdef COLLECT_STATS
+        rpn_stats.batch_rows += rows;
+        rpn_stats.batch_errors += failed;
+#endif
+        return failed;
+    }
+};
+
+// Number of arithmetic operations in a program before and after optimize
+struct OptimizeStats {
+    size_t operations_before = 0;
+    size_t operations_after = 0;
+};
+
+// Rewrites program into an equivalent program that does less work per evaluation.
+// The instructions are turned into a DAG in which identical subexpressions share one node, and while the
+// DAG is built:
+// - operations on two constants are folded (a division by a constant zero is kept, so it still fails at run time),
+// - x + 0, 0 + x, x - 0, x * 1, 1 * x and x / 1 become x,
+// - x * 0, 0 * x and x - x become 0 when x cannot divide by zero.
+// The DAG is then emitted back as instructions; a subexpression used more than once is computed once,
+// saved with Tee and read back with LoadTmp. Results and division-by-zero errors are the same as before.
+// A program that already uses temporaries (the output of an earlier optimize) is accepted: a LoadTmp stands for
+// the node saved by its Tee. Returns false and leaves program unchanged if it is empty, if an operation has
+// fewer than two operands, if a LoadTmp comes before the Tee of its temporary or if the program leaves more than
+// one value on the stack: only the top value is the result, but the others may still divide by zero.
+bool optimize(Program& program, OptimizeStats& stats) {
+    struct Node {
+        Op op;              // PushConst, PushVar or an arithmetic operation
+        int value;          // The constant of PushConst or the variable index of PushVar
+        uint32_t left;      // Operands of an arithmetic operation
+        uint32_t right;
+        bool can_fail;      // The subexpression contains an operation that may divide by zero or overflow
+    };
+    vector<Node> nodes;
+    map<tuple<Op, int, uint32_t, uint32_t>, uint32_t> node_index;  // Finds the existing node for a subexpression
+
+    stats = OptimizeStats();
+    auto makeNode = [&](Op op, int value, uint32_t left, uint32_t right, bool can_fail) {
+        auto inserted = node_index.emplace(make_tuple(op, value, left, right), (uint32_t)nodes.size());
+        if (inserted.second) {
+            nodes.push_back({op, value, left, right, can_fail});
+        }
+        return inserted.first->second;
+    };
+    auto isConstant = [&](uint32_t id, int value) {
+        return nodes[id].op == Op::PushConst && nodes[id].value == value;
+    };
+
+    // Build the DAG by running the program on a stack of node ids
+    vector<uint32_t> stack;
+    vector<int64_t> saved(program.temps, -1);   // Node saved in each temporary by Tee, -1 before its Tee
+    for (const Instruction& instruction : program.code) {
+        if (instruction.op == Op::PushConst) {
+            stack.push_back(makeNode(Op::PushConst, program.constants[instruction.arg], 0, 0, false));
+            continue;
+        }
+        if (instruction.op == Op::PushVar) {
+            stack.push_back(makeNode(Op::PushVar, instruction.arg, 0, 0, false));
+            continue;
+        }
+        if (instruction.op == Op::Tee) {
+            if (stack.empty() || instruction.arg >= saved.size()) {
+                return false;
+            }
+            saved[instruction.arg] = stack.back();
+            continue;
+        }
+        if (instruction.op == Op::LoadTmp) {
+            if (instruction.arg >= saved.size() || saved[instruction.arg] < 0) {
+                return false;
+            }
+            stack.push_back((uint32_t)saved[instruction.arg]);
+            continue;
+        }
+        if (stack.size() < 2) {
+            return false;
+        }
+        ++stats.operations_before;
+        Op op = instruction.op;
+        uint32_t y = stack.back();
+        stack.pop_back();
+        uint32_t x = stack.back();
+        stack.pop_back();
+        const Node a = nodes[x];
+        const Node b = nodes[y];
+        uint32_t result;
+        // Constants are folded only when the result fits into an int, so folding agrees with every backend
+        int folded = 0;
+        bool foldable = a.op == Op::PushConst && b.op == Op::PushConst
+            && (op == Op::Add ? !__builtin_add_overflow(a.value, b.value, &folded)
+              : op == Op::Sub ? !__builtin_sub_overflow(a.value, b.value, &folded)
+              : op == Op::Mul ? !__builtin_mul_overflow(a.value, b.value, &folded)
+              : b.value != 0 && !(a.value == INT_MIN && b.value == -1));
+        if (foldable) {
+            if (op == Op::Div) {
+                folded = floorDiv(a.value, b.value);
+            }
+            result = makeNode(Op::PushConst, folded, 0, 0, false);
+        } else if ((op == Op::Add && isConstant(y, 0)) || (op == Op::Sub && isConstant(y, 0))
+                || (op == Op::Mul && isConstant(y, 1)) || (op == Op::Div && isConstant(y, 1))) {
+            result = x;
+        } else if ((op == Op::Add && isConstant(x, 0)) || (op == Op::Mul && isConstant(x, 1))) {
+            result = y;
+        } else if ((op == Op::Mul && ((isConstant(x, 0) && !b.can_fail) || (isConstant(y, 0) && !a.can_fail)))
+                || (op == Op::Sub && x == y && !a.can_fail)) {
+            result = makeNode(Op::PushConst, 0, 0, 0, false);
         } else {
-            // The token is an operator
-            int operand2 = stack.top();
-            stack.pop();
-            int operand1 = stack.top();
-            stack.pop();
-
-            if (token == "+") {
-                stack.push(operand1 + operand2);
-            } else if (token == "-") {
-                stack.push(operand1 - operand2);
-            } else if (token == "*") {
-                stack.push(operand1 * operand2);
-            } else if (token == "/") {
-                // Division with truncation
-                if (operand2 != 0) {
-                    stack.push(floor((double)operand1 / operand2));
-                } else {
-                    cout << "Error: Division by zero" << endl;
-                    return INT_MIN; // Return a special value to indicate an error
+            if ((op == Op::Add || op == Op::Mul) && x > y) {
+                swap(x, y);     // Commutative operations are stored in one order, so a + b and b + a share a node
+            }
+            result = makeNode(op, 0, x, y, true);  // Any operation left may overflow in a checking backend
+        }
+        stack.push_back(result);
+    }
+    if (stack.size() != 1) {
+        return false;
+    }
+    uint32_t root = stack.back();
+
+    // Count how many times each node is used by the expression
+    vector<uint32_t> uses(nodes.size(), 0);
+    uses[root] = 1;
+    vector<uint32_t> pending = {root};
+    while (!pending.empty()) {
+        const Node& node = nodes[pending.back()];
+        pending.pop_back();
+        if (isArithmetic(node.op)) {
+            for (uint32_t child : {node.left, node.right}) {
+                if (uses[child]++ == 0) {
+                    pending.push_back(child);
                 }
             }
         }
     }
 
-    // The result of the computation is at the top of the stack
-    return stack.top();
+    // Emit the DAG in postfix order without recursion, so very deep expressions are handled too
+    Program optimized;
+    optimized.variables = program.variables;
+    map<int, uint32_t> constant_index;
+    vector<int32_t> temp(nodes.size(), -1);     // Temporary holding the value of an already emitted shared node
+    size_t depth = 0;
+    vector<pair<uint32_t, bool>> work = {{root, false}};   // (node, operands already emitted)
+    while (!work.empty()) {
+        uint32_t id = work.back().first;
+        bool expanded = work.back().second;
+        work.pop_back();
+        const Node& node = nodes[id];
+        if (node.op == Op::PushConst) {
+            auto inserted = constant_index.emplace(node.value, (uint32_t)optimized.constants.size());
+            if (inserted.second) {
+                optimized.constants.push_back(node.value);
+            }
+            optimized.code.push_back({Op::PushConst, inserted.first->second});
+            optimized.max_depth = max(optimized.max_depth, ++depth);
+        } else if (node.op == Op::PushVar) {
+            optimized.code.push_back({Op::PushVar, (uint32_t)node.value});
+            optimized.max_depth = max(optimized.max_depth, ++depth);
+        } else if (temp[id] >= 0) {
+            optimized.code.push_back({Op::LoadTmp, (uint32_t)temp[id]});
+            optimized.max_depth = max(optimized.max_depth, ++depth);
+        } else if (!expanded) {
+            work.push_back({id, true});
+            work.push_back({node.right, false});
+            work.push_back({node.left, false});     // Popped first: the left operand is emitted first
+        } else {
+            optimized.code.push_back({node.op, 0});
+            --depth;
+            ++stats.operations_after;
+            if (uses[id] > 1) {
+                temp[id] = (int32_t)optimized.temps++;
+                optimized.code.push_back({Op::Tee, (uint32_t)temp[id]});
+            }
+        }
+    }
+
+    program = std::move(optimized);
+    return true;
 }
 
-int main() {
-    string input;
-    getline(cin, input); // Read the expression as a single line
+// Evaluates a compiled expression with all variables set to 0.
+// Prints an error message and returns INT_MIN if it divides by zero.
+int evaluateProgram(const Program& program) {
+    vector<int> vars(program.variables.size(), 0);     // Variables that are never bound evaluate to 0
+    int result;
+    if (Evaluator<>().run(program, vars.data(), result) == Status::DivisionByZero) {
+        cout << "Error: Division by zero" << endl;
+        return INT_MIN; // Return a special value to indicate an error
+    }
+    return result;
+}
 
-    vector<string> tokens;
+// Function to evaluate Reverse Polish Notation expressions
+int evaluateRPN(vector<string>& tokens) {
+    Program program;
+    if (!compileRPN(tokens, program)) {
+        cout << "Error: Invalid expression" << endl;
+        return INT_MIN; // Return a special value to indicate an error
+    }
+    return evaluateProgram(program);
+}
 
-    // Split the input string into tokens
-    size_t pos = 0;
-    while ((pos = input.find(' ')) != string::npos) {
-        string token = input.substr(0, pos);
-        tokens.push_back(token);
-        input.erase(0, pos + 1);
+int main() {
+    // Compile the expression while it is being read: each token is compiled as soon as it is found
+    // and never stored, so the time and memory needed do not grow faster than the line itself
+    TokenReader reader;
+    Compiler compiler;
+    string_view token;
+    while (reader.next(token) && compiler.add(token)) {
     }
-    tokens.push_back(input); // Add the last token
 
-    // Compute and output the result
-    int result = evaluateRPN(tokens);
-    if (result != INT_MIN) {
-        cout << result << endl;
+    Program program;
+    if (!compiler.finish(program)) {
+        cout << "Error: Invalid expression" << endl;
+    } else {
+        // Compute and output the result
+        int result = evaluateProgram(program);
+        if (result != INT_MIN) {
+            cout << result << endl;
+        }
     }
 
+#ifdef COLLECT_STATS
+    rpn_stats.print(stderr, false);     // Kept out of the answer on stdout
+#endif
     return 0;
 }
@@ -2,6 +2,7 @@
 #include "solution.h"
 #endif
 
+#include <cstddef>
 #include <iostream>
 #include <string>
 
@@ -30,7 +31,11 @@ Key Components:
     solution Function:
     This function:
         Starts with the head of the list and traverses each node.
-        Prints the value of the current node.
+        Appends the value of the current node and a line break to an output buffer.
+        Writes the buffer with one call whenever it reaches OUTPUT_BLOCK bytes, and once more at the end,
+        instead of flushing the stream after every value with std::endl.
+        Asks the CPU (with __builtin_prefetch on GCC and Clang) to start loading the next node
+        while the current value is being copied, to hide part of the pointer-chasing latency.
         Advances to the next node using the next pointer.
         Stops when it encounters a nullptr, indicating the end of the list.
     Test Function:
@@ -46,13 +51,30 @@ This code demonstrates how to define and traverse a singly linked list using a s
 
 #endif
 
+const std::size_t OUTPUT_BLOCK = 1 << 16;  // The output is written in blocks of about this many bytes
+
 // Function to print all elements in the linked list
 void solution(Node* head) {
+    std::string output;  // Values collected here and written in large blocks instead of one flush per line
+    output.reserve(OUTPUT_BLOCK + 64);
     Node* current = head;  // Pointer to the current node, starting from the head of the list
     while (current != nullptr) {  // Traverse the list until reaching the end (nullptr)
-        std::cout << current->value << std::endl;  // Print the value of the current node
-        current = current->next;  // Move to the next node
+        Node* next = current->next;
+#ifdef __GNUC__
+        if (next != nullptr) {
+            __builtin_prefetch(next);  // Start loading the next node while the current value is being copied
+        }
+#endif
+        output += current->value;  // Add the value of the current node
+        output += '\n';
+        if (output.size() >= OUTPUT_BLOCK) {
+            std::cout.write(output.data(), output.size());
+            output.clear();
+        }
+        current = next;  // Move to the next node
     }
+    std::cout.write(output.data(), output.size());
+    std::cout.flush();  // Like the std::endl it replaces, make the output visible before returning
 }
 
 #ifndef REMOTE_JUDGE
@@ -75,6 +97,7 @@ void test() {
 
 int main() {
     test();  // Call the test function
+    return 0;
 }
 
 #endif
\ No newline at end of file
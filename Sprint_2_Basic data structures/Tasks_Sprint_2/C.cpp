@@ -12,6 +12,16 @@ Algorithm Description in Comments
     Returning the Updated List:
         After modifying the list, the function returns the original head unless it was the node removed (handled in step 1).
         This approach ensures efficient memory management and maintains the structure of the list with a time complexity of O(n), where n is the index of the node to be removed.
+    Node Memory in the Local Build:
+        Outside the judge, Node has its own operator new and operator delete backed by NodePool.
+        The pool carves nodes out of slabs of 1024 and keeps freed nodes in a free list that is reused first,
+        so `new Node` and the `delete` in solution cost a few pointer moves instead of a heap call,
+        and nodes created together lie next to each other in memory.
+        Once every node has been deleted, NodePool::reset drops the free list in O(1) and keeps the slabs,
+        so the next nodes are handed out in slab order and lie next to each other again.
+        The pool counts its live nodes and reset asserts that there are none, since forgetting a live node
+        would skip its destructor and leak any value too long to be stored inside std::string.
+        The judge supplies its own Node through solution.h, so there solution keeps using the global heap.
 */
 
 #ifdef REMOTE_JUDGE
@@ -20,14 +30,97 @@ Algorithm Description in Comments
 
 #ifndef REMOTE_JUDGE
 #include <cassert>
+#include <cstddef>
 #include <string>
+#include <vector>
 
 // Definition of the structure for a node in a singly linked list
 struct Node {  
     std::string value;  // Value of the node
     Node* next;         // Pointer to the next node
     Node(const std::string &value, Node* next) : value(value), next(next) {}
+
+    // Nodes created with new come from NodePool
+    static void* operator new(std::size_t size);
+    static void operator delete(void* node);
+};
+
+// Allocates Nodes from slabs of NODES_PER_SLAB nodes instead of one heap allocation per node.
+// Freed nodes are kept in a free list and handed out again before the slabs are used further.
+class NodePool {
+private:
+    static const std::size_t NODES_PER_SLAB = 1024;
+
+    union Slot {
+        Slot* next_free;                                    // Link in the free list while the slot is unused
+        alignas(Node) unsigned char storage[sizeof(Node)];  // The node while the slot is in use
+    };
+
+    std::vector<Slot*> slabs;   // Every slab allocated so far; they are only released by the destructor
+    std::size_t next_slab = 0;  // Index in slabs of the slab to open when the current one runs out
+    Slot* cursor = nullptr;     // Next never-used slot of the current slab
+    Slot* end = nullptr;        // End of the current slab
+    Slot* free_list = nullptr;  // Slots of deleted nodes
+    std::size_t live = 0;       // Nodes allocated and not yet deallocated
+
+public:
+    static NodePool& instance() {
+        static NodePool pool;
+        return pool;
+    }
+
+    ~NodePool() {
+        for (Slot* slab : slabs) {
+            delete[] slab;
+        }
+    }
+
+    std::size_t liveNodes() const {
+        return live;
+    }
+
+    void* allocate() {
+        ++live;
+        if (free_list != nullptr) {  // Reuse the most recently freed node
+            Slot* slot = free_list;
+            free_list = slot->next_free;
+            return slot;
+        }
+        if (cursor == end) {  // The current slab is used up: open the next one
+            if (next_slab == slabs.size()) {
+                slabs.push_back(new Slot[NODES_PER_SLAB]);
+            }
+            cursor = slabs[next_slab++];
+            end = cursor + NODES_PER_SLAB;
+        }
+        return cursor++;
+    }
+
+    void deallocate(void* node) {
+        --live;
+        Slot* slot = static_cast<Slot*>(node);
+        slot->next_free = free_list;
+        free_list = slot;
+    }
+
+    // Drops the free list in O(1); the slabs are kept and filled again from the start.
+    // Every node must have been deleted first: reset runs no destructors.
+    void reset() {
+        assert(live == 0 && "every node must be deleted before the pool is reset");
+        next_slab = 0;
+        cursor = end = nullptr;
+        free_list = nullptr;
+    }
 };
+
+void* Node::operator new(std::size_t size) {
+    assert(size == sizeof(Node));  // Classes derived from Node would not fit into a slot
+    return NodePool::instance().allocate();
+}
+
+void Node::operator delete(void* node) {
+    NodePool::instance().deallocate(node);
+}
 #endif
 
 // Function to delete an element from the list by a given index
@@ -59,19 +152,34 @@ Node* solution(Node* head, int idx) {
 #ifndef REMOTE_JUDGE
 // Test function to verify the solution works correctly
 void test() {
-    Node node3("node3", nullptr);
-    Node node2("node2", &node3);
-    Node node1("node1", &node2);
-    Node node0("node0", &node1);
-    Node* new_head = solution(&node0, 1);  // Remove the node at index 1 (node1)
-    assert(new_head == &node0);  // Ensure the head of the list remains unchanged
-    assert(new_head->next == &node2);  // Ensure node0 now points to node2
-    assert(new_head->next->next == &node3);  // Ensure node2 points to node3
+    // Nodes are created with new because solution deletes the removed node
+    Node* node3 = new Node("node3", nullptr);
+    Node* node2 = new Node("node2", node3);
+    Node* node1 = new Node("node1", node2);
+    Node* node0 = new Node("node0", node1);
+    Node* new_head = solution(node0, 1);  // Remove the node at index 1 (node1)
+    assert(new_head == node0);  // Ensure the head of the list remains unchanged
+    assert(new_head->next == node2);  // Ensure node0 now points to node2
+    assert(new_head->next->next == node3);  // Ensure node2 points to node3
     assert(new_head->next->next->next == nullptr);  // Ensure node3 is the last node
     // Resulting list: node0 -> node2 -> node3
+
+    Node* node4 = new Node("node4", nullptr);
+    assert(node4 == node1);  // The pool hands out the slot of the deleted node first
+    delete node4;
+
+    while (new_head != nullptr) {  // Delete node0, node2 and node3 by removing the head until the list is empty
+        new_head = solution(new_head, 0);
+    }
+    assert(NodePool::instance().liveNodes() == 0);
+    NodePool::instance().reset();
+    Node* node5 = new Node("node5", nullptr);
+    assert(node5 == node3);  // After the reset the first slot of the first slab is handed out again
+    delete node5;
 }
 
 int main() {
     test();  // Call the test function
+    return 0;
 }
 #endif
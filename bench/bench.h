@@ -0,0 +1,291 @@
+/*
+Shared part of the benchmark drivers in this directory.
+
+Every driver includes its solution with `main` renamed to `solution_main`, as the tests in tests/ do, so the
+solution is benchmarked exactly as it is submitted. A driver generates its inputs, times either the whole program
+(`runSolution`, stdin read from a generated file and stdout discarded) or some of its functions and classes, and
+writes one JSON object with all measurements.
+
+Every measurement is repeated; the JSON has the best and the median wall time and, for the best run, the counters
+that `perf_event_open` gives access to. A counter the kernel refuses to open (no PMU in a virtual machine,
+`perf_event_paranoid`, a non-Linux system) is written as null instead of failing the run.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+// Counters of the calling thread and of the threads it starts while the counters run
+class PerfCounters {
+public:
+    enum Event { CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, TASK_CLOCK_NS, PAGE_FAULTS, EVENTS };
+    static constexpr const char* NAMES[EVENTS] = {
+        "cycles", "instructions", "cache_misses", "branch_misses", "task_clock_ns", "page_faults"};
+
+private:
+    int fds[EVENTS];        // -1 for a counter that could not be opened
+
+public:
+    PerfCounters() {
+        std::fill(fds, fds + EVENTS, -1);
+#ifdef __linux__
+        const std::pair<uint32_t, uint64_t> events[EVENTS] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+            {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+        };
+        for (int e = 0; e < EVENTS; ++e) {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = events[e].first;
+            attr.config = events[e].second;
+            attr.disabled = 1;
+            attr.inherit = 1;           // Threads started by the measured code are counted too
+            attr.exclude_kernel = 1;    // Allowed with the default perf_event_paranoid = 2
+            attr.exclude_hv = 1;
+            fds[e] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    void start() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    // Stops the counters and stores their values; a counter that is not available gets -1
+    void stop(int64_t values[EVENTS]) {
+        for (int e = 0; e < EVENTS; ++e) {
+            values[e] = -1;
+#ifdef __linux__
+            uint64_t value;
+            if (fds[e] >= 0 && ioctl(fds[e], PERF_EVENT_IOC_DISABLE, 0) == 0
+                    && read(fds[e], &value, sizeof(value)) == (ssize_t)sizeof(value)) {
+                values[e] = (int64_t)value;
+            }
+#endif
+        }
+    }
+};
+
+// Result of one repeated measurement
+struct Timing {
+    double best_seconds = 0;
+    double median_seconds = 0;
+    int64_t counters[PerfCounters::EVENTS];     // Of the fastest run; -1 if not available
+};
+
+// Runs body `repetitions` times and returns the best and the median wall time.
+// setup runs before every repetition and is not timed, e.g. to rebuild what body consumes.
+template <typename Setup, typename Body>
+Timing measure(int repetitions, const Setup& setup, const Body& body) {
+    static PerfCounters perf;       // Opened once: perf_event_open is too slow to call for every run
+    Timing timing;
+    std::vector<double> seconds;
+    for (int r = 0; r < repetitions; ++r) {
+        setup();
+        int64_t counters[PerfCounters::EVENTS];
+        perf.start();
+        auto start = std::chrono::steady_clock::now();
+        body();
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        perf.stop(counters);
+        if (seconds.empty() || elapsed < timing.best_seconds) {
+            timing.best_seconds = elapsed;
+            std::copy(counters, counters + PerfCounters::EVENTS, timing.counters);
+        }
+        seconds.push_back(elapsed);
+    }
+    std::sort(seconds.begin(), seconds.end());
+    timing.median_seconds = seconds[seconds.size() / 2];
+    return timing;
+}
+
+template <typename Body>
+Timing measure(int repetitions, const Body& body) {
+    return measure(repetitions, []() {}, body);
+}
+
+// A file in the temporary directory that is removed when the object goes away
+class TempFile {
+private:
+    std::string file_path;
+
+public:
+    TempFile() {
+        char pattern[] = "/tmp/bench_XXXXXX";
+        int fd = mkstemp(pattern);
+        if (fd < 0) {
+            perror("mkstemp");
+            exit(1);
+        }
+        close(fd);
+        file_path = pattern;
+    }
+    ~TempFile() { remove(file_path.c_str()); }
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    const char* path() const { return file_path.c_str(); }
+
+    // Opens the file for writing, truncating it
+    FILE* open() const {
+        FILE* file = fopen(file_path.c_str(), "w");
+        if (file == nullptr) {
+            perror(file_path.c_str());
+            exit(1);
+        }
+        return file;
+    }
+
+    long size() const {
+        FILE* file = fopen(file_path.c_str(), "r");
+        fseek(file, 0, SEEK_END);
+        long bytes = ftell(file);
+        fclose(file);
+        return bytes;
+    }
+};
+
+// Sends stdout (and std::cout, which writes through it) to /dev/null, so timed code can print
+inline void discardStdout() {
+    if (freopen("/dev/null", "w", stdout) == nullptr) {
+        perror("freopen");
+        exit(1);
+    }
+}
+
+// Runs the main function of a solution with stdin read from input_path and stdout discarded
+inline void runSolution(int (*solution_main)(), const char* input_path) {
+    if (freopen(input_path, "r", stdin) == nullptr) {
+        perror(input_path);
+        exit(1);
+    }
+    discardStdout();
+    solution_main();
+    fflush(stdout);
+}
+
+// Collects the measurements of one driver and writes them as
+// {"benchmark": ..., "results": [{"name": ..., <parameters>, "best_seconds": ..., ..., "counters": {...}}, ...]}.
+// Every measurement is also printed to stderr as one readable line.
+class JsonReport {
+private:
+    using Fields = std::vector<std::pair<std::string, double>>;
+
+    struct Entry {
+        std::string name;
+        Fields parameters;      // What was measured, e.g. the matrix size or the number of commands
+        Timing timing;
+        Fields rates;           // Values derived from the best time, e.g. GB/s or ns per command
+    };
+
+    std::string benchmark;
+    std::vector<Entry> entries;
+
+    static void writeFields(FILE* out, const Fields& fields) {
+        for (const auto& field : fields) {
+            fprintf(out, ", \"%s\": %.6g", field.first.c_str(), field.second);
+        }
+    }
+
+public:
+    explicit JsonReport(std::string benchmark) : benchmark(std::move(benchmark)) {}
+
+    void add(std::string name, Fields parameters, const Timing& timing, Fields rates) {
+        fprintf(stderr, "%-24s", name.c_str());
+        for (const auto& field : parameters) {
+            fprintf(stderr, " %s=%g", field.first.c_str(), field.second);
+        }
+        fprintf(stderr, "  best %.4f s  median %.4f s", timing.best_seconds, timing.median_seconds);
+        for (const auto& field : rates) {
+            fprintf(stderr, "  %s=%.4g", field.first.c_str(), field.second);
+        }
+        fprintf(stderr, "\n");
+        entries.push_back({std::move(name), std::move(parameters), timing, std::move(rates)});
+    }
+
+    void write(FILE* out) const {
+        fprintf(out, "{\"benchmark\": \"%s\", \"results\": [", benchmark.c_str());
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const Entry& entry = entries[i];
+            fprintf(out, "%s\n  {\"name\": \"%s\"", i > 0 ? "," : "", entry.name.c_str());
+            writeFields(out, entry.parameters);
+            fprintf(out, ", \"best_seconds\": %.6g, \"median_seconds\": %.6g",
+                    entry.timing.best_seconds, entry.timing.median_seconds);
+            writeFields(out, entry.rates);
+            fprintf(out, ", \"counters\": {");
+            for (int e = 0; e < PerfCounters::EVENTS; ++e) {
+                fprintf(out, "%s\"%s\": ", e > 0 ? ", " : "", PerfCounters::NAMES[e]);
+                if (entry.timing.counters[e] < 0) {
+                    fprintf(out, "null");
+                } else {
+                    fprintf(out, "%lld", (long long)entry.timing.counters[e]);
+                }
+            }
+            fprintf(out, "}}");
+        }
+        fprintf(out, "\n]}\n");
+    }
+};
+
+// Command line shared by the drivers: [--large] [output.json].
+// --large adds the biggest inputs; without a file name the JSON goes to the original stdout.
+struct BenchOptions {
+    bool large = false;
+    FILE* json = nullptr;
+
+    BenchOptions(int argc, char** argv) {
+        for (int i = 1; i < argc; ++i) {
+            if (strcmp(argv[i], "--large") == 0) {
+                large = true;
+            } else if ((json = fopen(argv[i], "w")) == nullptr) {
+                perror(argv[i]);
+                exit(1);
+            }
+        }
+        if (json == nullptr) {
+            json = fdopen(dup(fileno(stdout)), "w");    // runSolution redirects stdout itself
+        }
+    }
+
+    ~BenchOptions() { fclose(json); }
+};
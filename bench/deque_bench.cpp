@@ -0,0 +1,238 @@
+// Benchmark of Final_Tasks_2/A.cpp (deque on a circular buffer).
+// The whole program is timed on generated command lists: commands drawn uniformly at random, and runs of 700
+// equal commands, each with a small maximum size (kept inline) and a large one (heap buffer).
+// 10^6 commands per input, 10^7 with --large.
+// The deque classes are also timed on their own, on 10^7 pushes and pops held in memory: CircularDeque<int> with
+// both growth policies, InlineCircularDeque, std::deque<int> and the deque of the original solution.
+
+#define main solution_main
+#include "../Sprint_2_Basic data structures/Final_Tasks_2/A.cpp"
+#undef main
+
+#include "bench.h"
+
+#include <deque>
+#include <random>
+
+const char* const COMMANDS[] = {"push_back", "push_front", "pop_back", "pop_front"};
+
+// Writes n commands for a deque of maximum size m.
+// run_length 1 draws every command on its own; a larger value repeats each drawn command that many times.
+void generate(FILE* file, size_t n, size_t m, size_t run_length, unsigned seed) {
+    mt19937 random(seed);
+    uniform_int_distribution<int> command(0, 3);
+    uniform_int_distribution<int> value(-1000, 1000);
+    fprintf(file, "%zu\n%zu\n", n, m);
+    int current = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (i % run_length == 0) {
+            current = command(random);
+        }
+        if (current < 2) {
+            fprintf(file, "%s %d\n", COMMANDS[current], value(random));
+        } else {
+            fprintf(file, "%s\n", COMMANDS[current]);
+        }
+    }
+}
+
+// The deque of the original solution, with its `%` index arithmetic and its int-sized fields.
+// It returns its results like the other deques instead of printing them, so only the data structures differ.
+class ModuloDeque {
+private:
+    vector<int> buffer;
+    int max_size;
+    int front_index;
+    int back_index;
+    int current_size;
+
+public:
+    explicit ModuloDeque(int m) : buffer(m), max_size(m), front_index(0), back_index(0), current_size(0) {}
+
+    bool push_back(int value) {
+        if (current_size == max_size) {
+            return false;
+        }
+        buffer[back_index] = value;
+        back_index = (back_index + 1) % max_size;
+        ++current_size;
+        return true;
+    }
+
+    bool push_front(int value) {
+        if (current_size == max_size) {
+            return false;
+        }
+        front_index = (front_index - 1 + max_size) % max_size;
+        buffer[front_index] = value;
+        ++current_size;
+        return true;
+    }
+
+    bool pop_back(int& value) {
+        if (current_size == 0) {
+            return false;
+        }
+        back_index = (back_index - 1 + max_size) % max_size;
+        value = buffer[back_index];
+        --current_size;
+        return true;
+    }
+
+    bool pop_front(int& value) {
+        if (current_size == 0) {
+            return false;
+        }
+        value = buffer[front_index];
+        front_index = (front_index + 1) % max_size;
+        --current_size;
+        return true;
+    }
+};
+
+// std::deque<int> with the same interface and the same maximum size as the other deques
+class StdDeque {
+private:
+    std::deque<int> elements;
+    size_t max_size;
+
+public:
+    explicit StdDeque(size_t m) : max_size(m) {}
+
+    bool push_back(int value) {
+        if (elements.size() == max_size) {
+            return false;
+        }
+        elements.push_back(value);
+        return true;
+    }
+
+    bool push_front(int value) {
+        if (elements.size() == max_size) {
+            return false;
+        }
+        elements.push_front(value);
+        return true;
+    }
+
+    bool pop_back(int& value) {
+        if (elements.empty()) {
+            return false;
+        }
+        value = elements.back();
+        elements.pop_back();
+        return true;
+    }
+
+    bool pop_front(int& value) {
+        if (elements.empty()) {
+            return false;
+        }
+        value = elements.front();
+        elements.pop_front();
+        return true;
+    }
+};
+
+// Operation codes of the microbenchmarks: the index into COMMANDS
+vector<uint8_t> randomOperations(size_t n, unsigned seed) {
+    mt19937 random(seed);
+    vector<uint8_t> operations(n);
+    for (uint8_t& operation : operations) {
+        operation = (uint8_t)(random() % 4);
+    }
+    return operations;
+}
+
+// Fills the deque to m elements from both ends and empties it again from both ends, over and over,
+// so the indices wrap around the buffer all the time
+vector<uint8_t> fillDrainOperations(size_t n, size_t m) {
+    vector<uint8_t> operations(n);
+    for (size_t i = 0; i < n; ++i) {
+        size_t phase = i % (2 * m);
+        operations[i] = (uint8_t)((phase < m ? 0 : 2) + phase % 2);
+    }
+    return operations;
+}
+
+// Runs the operations on deque and returns a checksum of the results, so that nothing is optimized away
+template <typename Deque>
+long long runOperations(Deque& deque, const vector<uint8_t>& operations) {
+    long long checksum = 0;
+    int value = 0;
+    for (size_t i = 0; i < operations.size(); ++i) {
+        switch (operations[i]) {
+        case 0:
+            checksum += deque.push_back((int)i);
+            break;
+        case 1:
+            checksum += deque.push_front((int)i);
+            break;
+        case 2:
+            checksum += deque.pop_back(value) ? value : -1;
+            break;
+        case 3:
+            checksum += deque.pop_front(value) ? value : -1;
+            break;
+        }
+    }
+    return checksum;
+}
+
+// Times one deque class on the operations; makeDeque creates a new deque for every repetition
+template <typename MakeDeque>
+void benchDeque(JsonReport& report, const string& name, const string& pattern, size_t m,
+                const vector<uint8_t>& operations, const MakeDeque& makeDeque) {
+    long long checksum = 0;
+    Timing timing = measure(5, [&]() {
+        auto deque = makeDeque();
+        checksum = runOperations(*deque, operations);
+    });
+    report.add(name + "_" + pattern, {{"n", (double)operations.size()}, {"m", (double)m}, {"checksum", (double)checksum}},
+               timing, {{"ns_per_operation", timing.best_seconds * 1e9 / operations.size()}});
+}
+
+void benchDequeClasses(JsonReport& report) {
+    const size_t n = 10000000;
+    for (size_t m : {1000, 100000}) {
+        for (string pattern : {"random", "fill_drain"}) {
+            vector<uint8_t> operations = pattern == "random" ? randomOperations(n, (unsigned)m) : fillDrainOperations(n, m);
+            benchDeque(report, "circular_fixed", pattern, m, operations,
+                       [&]() { return make_unique<CircularDeque<int>>(m, Growth::Fixed); });
+            benchDeque(report, "circular_geometric", pattern, m, operations,
+                       [&]() { return make_unique<CircularDeque<int>>(m, Growth::Geometric); });
+            if (m <= INLINE_CAPACITY) {
+                benchDeque(report, "inline", pattern, m, operations,
+                           [&]() { return make_unique<InlineCircularDeque<int, INLINE_CAPACITY>>(m); });
+            }
+            benchDeque(report, "std_deque", pattern, m, operations, [&]() { return make_unique<StdDeque>(m); });
+            benchDeque(report, "original_modulo", pattern, m, operations,
+                       [&]() { return make_unique<ModuloDeque>((int)m); });
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options(argc, argv);
+    JsonReport report("deque");
+
+    size_t n = options.large ? 10000000 : 1000000;
+    for (size_t run_length : {1, 700}) {
+        for (size_t m : {8, 1000, 100000}) {
+            TempFile input;
+            FILE* file = input.open();
+            generate(file, n, m, run_length, (unsigned)(m + run_length));
+            fclose(file);
+            Timing timing = measure(5, [&]() { runSolution(solution_main, input.path()); });
+            report.add(run_length == 1 ? "random_commands" : "command_runs",
+                       {{"n", (double)n}, {"m", (double)m}, {"run_length", (double)run_length}}, timing,
+                       {{"ns_per_command", timing.best_seconds * 1e9 / n},
+                        {"input_mb_per_s", input.size() / timing.best_seconds / 1e6}});
+        }
+    }
+
+    benchDequeClasses(report);
+
+    report.write(options.json);
+    return 0;
+}
@@ -0,0 +1,121 @@
+// Benchmark of Tasks_Sprint_2/B.cpp and C.cpp (singly linked lists).
+// A list of 10^6 nodes (10^7 with --large) is built by inserting at the head, traversed and emptied node by node
+// by removing index 0, once with the nodes of C.cpp, which come from NodePool, and once with the nodes of B.cpp,
+// which are allocated with new and delete like the nodes of the original solutions. Values are short strings
+// that fit inside std::string, so the time is spent on the nodes and not on the characters.
+// The printer of B.cpp is compared with the original one, which flushes with std::endl after every value.
+// Both solutions define Node, solution, test and main, so each is included in a namespace of its own.
+
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace list_print {
+#define main solution_main
+#include "../Sprint_2_Basic data structures/Tasks_Sprint_2/B.cpp"
+#undef main
+}
+
+namespace list_remove {
+#define main solution_main
+#include "../Sprint_2_Basic data structures/Tasks_Sprint_2/C.cpp"
+#undef main
+}
+
+#include "bench.h"
+
+using namespace std;
+
+double nanosecondsPerNode(size_t n, const Timing& timing) {
+    return timing.best_seconds * 1e9 / n;
+}
+
+// Builds a list of n nodes by inserting each one at the head
+template <typename ListNode>
+ListNode* buildList(size_t n) {
+    ListNode* head = nullptr;
+    for (size_t i = 0; i < n; ++i) {
+        head = new ListNode("node" + to_string(i), head);
+    }
+    return head;
+}
+
+// Total length of the values, so the traversal cannot be optimized away
+template <typename ListNode>
+size_t traverse(const ListNode* head) {
+    size_t characters = 0;
+    for (const ListNode* node = head; node != nullptr; node = node->next) {
+        characters += node->value.size();
+    }
+    return characters;
+}
+
+// Removes the head of a list of B.cpp nodes the way the solution of C.cpp does, with the global delete
+list_print::Node* removeHeadWithDelete(list_print::Node* head) {
+    list_print::Node* new_head = head->next;
+    delete head;
+    return new_head;
+}
+
+// Removes the head of a list of C.cpp nodes with its solution, which returns the node to NodePool
+list_remove::Node* removeHeadFromPool(list_remove::Node* head) {
+    return list_remove::solution(head, 0);
+}
+
+// Insertion, traversal and removal of n nodes. `kind` names the allocator: "pool" for the nodes of C.cpp,
+// which come from NodePool, and "new_delete" for the nodes of B.cpp, one heap allocation each as in the original.
+template <typename ListNode>
+void benchListOperations(JsonReport& report, const string& kind, size_t n, ListNode* (*removeHead)(ListNode*)) {
+    ListNode* head = nullptr;
+    auto removeAll = [&]() {
+        while (head != nullptr) {
+            head = removeHead(head);
+        }
+    };
+    Timing insert = measure(5, removeAll, [&]() { head = buildList<ListNode>(n); });
+    size_t characters = 0;
+    Timing walk = measure(5, [&]() { characters = traverse(head); });
+    Timing remove = measure(5, [&]() { removeAll(); head = buildList<ListNode>(n); }, removeAll);
+    report.add("insert_" + kind, {{"n", (double)n}}, insert, {{"ns_per_node", nanosecondsPerNode(n, insert)}});
+    report.add("traverse_" + kind, {{"n", (double)n}, {"characters", (double)characters}}, walk,
+               {{"ns_per_node", nanosecondsPerNode(n, walk)}});
+    report.add("remove_head_" + kind, {{"n", (double)n}}, remove, {{"ns_per_node", nanosecondsPerNode(n, remove)}});
+}
+
+// The printer of the original B.cpp: every value is written with std::endl, which flushes stdout each time
+void printWithEndl(list_print::Node* head) {
+    for (list_print::Node* current = head; current != nullptr; current = current->next) {
+        std::cout << current->value << std::endl;
+    }
+}
+
+// The printer of B.cpp against the original one, with stdout discarded
+void benchPrint(JsonReport& report, size_t n) {
+    using Node = list_print::Node;
+    Node* head = buildList<Node>(n);
+    Timing timing = measure(5, [&]() { list_print::solution(head); });
+    report.add("print_buffered", {{"n", (double)n}}, timing, {{"ns_per_node", nanosecondsPerNode(n, timing)}});
+    timing = measure(3, [&]() { printWithEndl(head); });
+    report.add("print_endl", {{"n", (double)n}}, timing, {{"ns_per_node", nanosecondsPerNode(n, timing)}});
+    while (head != nullptr) {
+        Node* next = head->next;
+        delete head;
+        head = next;
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options(argc, argv);
+    JsonReport report("list");
+    discardStdout();
+
+    size_t n = options.large ? 10000000 : 1000000;
+    benchListOperations(report, "pool", n, removeHeadFromPool);
+    benchListOperations(report, "new_delete", n, removeHeadWithDelete);
+    benchPrint(report, n);
+
+    report.write(options.json);
+    return 0;
+}
@@ -0,0 +1,287 @@
+// Benchmark of Final_Tasks_2/B.cpp (Reverse Polish Notation).
+// The whole program is timed on one generated expression of 10^5 and 10^6 tokens (and 10^7 with --large):
+// once with numbers only, and once with variable names among the numbers.
+// The tokenizer of the solution is also timed against the splitter of the original solution on lines of
+// 10^4 to 10^5 tokens, to show how each one scales with the length of the line.
+// Compiled programs are timed on a corpus of short expressions, each evaluated with many variable bindings:
+// as compiled and after optimize, and with each numeric backend against the int and double arithmetic of the
+// original solution, both row by row with run and in blocks of rows with runBatch.
+
+#define main solution_main
+#include "../Sprint_2_Basic data structures/Final_Tasks_2/B.cpp"
+#undef main
+
+#include "bench.h"
+
+#include <cmath>
+#include <random>
+
+// Generates a valid expression of about `tokens` tokens and passes the tokens to emit one by one.
+// Operands are numbers in [-9, 9] and, if with_variables, also one of 26 one-letter variables.
+// Division by a number is avoided by dividing only when the right operand is a nonzero literal.
+template <typename Emit>
+void generateTokens(size_t tokens, bool with_variables, unsigned seed, const Emit& emit) {
+    mt19937 random(seed);
+    uniform_int_distribution<int> digit(-9, 9);
+    uniform_int_distribution<int> letter(0, 25);
+    uniform_int_distribution<int> coin(0, 1);
+    const char* const OPERATORS[] = {"+", "-", "*"};
+    size_t depth = 0;
+    bool last_was_nonzero_literal = false;
+    for (size_t i = 0; i < tokens || depth > 1; ++i) {
+        if (depth >= 2 && (i >= tokens || coin(random))) {
+            if (last_was_nonzero_literal && coin(random)) {
+                emit("/");
+            } else {
+                emit(OPERATORS[letter(random) % 3]);
+            }
+            --depth;
+            last_was_nonzero_literal = false;
+        } else if (with_variables && coin(random)) {
+            emit(string(1, (char)('a' + letter(random))));
+            ++depth;
+            last_was_nonzero_literal = false;
+        } else {
+            int value = digit(random);
+            emit(to_string(value));
+            ++depth;
+            last_was_nonzero_literal = value != 0;
+        }
+    }
+}
+
+// Writes a generated expression on one line
+void generate(FILE* file, size_t tokens, bool with_variables, unsigned seed) {
+    bool first = true;
+    generateTokens(tokens, with_variables, seed, [&](const string& token) {
+        fprintf(file, first ? "%s" : " %s", token.c_str());
+        first = false;
+    });
+    fputc('\n', file);
+}
+
+// Opens input_path as stdin for both stdio and cin
+void readFrom(const char* input_path) {
+    if (freopen(input_path, "r", stdin) == nullptr) {
+        perror(input_path);
+        exit(1);
+    }
+    cin.clear();
+}
+
+// The splitter of the original solution: every token is cut off the front of the line with substr and erase,
+// and erase moves the whole rest of the line each time. Returns the number of tokens.
+size_t splitOriginal() {
+    string input;
+    getline(cin, input);
+    vector<string> tokens;
+    size_t pos = 0;
+    while ((pos = input.find(' ')) != string::npos) {
+        string token = input.substr(0, pos);
+        tokens.push_back(token);
+        input.erase(0, pos + 1);
+    }
+    tokens.push_back(input);
+    return tokens.size();
+}
+
+// The tokenizer of the solution on the same line. Returns the number of tokens.
+size_t splitStreaming() {
+    TokenReader reader;
+    string_view token;
+    size_t count = 0;
+    while (reader.next(token)) {
+        ++count;
+    }
+    return count;
+}
+
+void benchSplitters(JsonReport& report) {
+    for (size_t tokens : {10000, 30000, 100000}) {
+        TempFile input;
+        FILE* file = input.open();
+        generate(file, tokens, false, (unsigned)tokens);
+        fclose(file);
+        for (bool original : {false, true}) {
+            size_t count = 0;
+            Timing timing = measure(3, [&]() { readFrom(input.path()); },
+                                    [&]() { count = original ? splitOriginal() : splitStreaming(); });
+            report.add(original ? "split_original" : "split_streaming", {{"tokens", (double)count}}, timing,
+                       {{"ns_per_token", timing.best_seconds * 1e9 / count}});
+        }
+    }
+}
+
+const size_t CORPUS_EXPRESSIONS = 1000;
+const size_t CORPUS_BINDINGS = 1000;    // Variable bindings every expression of the corpus is evaluated with
+const size_t VARIABLES = 26;            // Values in one binding, one per possible variable
+
+// Expressions of about 40 tokens over the variables and small numbers. Every second one is an expression
+// written twice and multiplied, "E E *", like a formula that repeats a subexpression.
+struct Corpus {
+    vector<vector<string>> tokens;
+    vector<Program> programs;       // The tokens, compiled
+    vector<int> bindings;           // CORPUS_BINDINGS rows of VARIABLES values in [-9, 9] without 0
+};
+
+Corpus makeCorpus() {
+    Corpus corpus;
+    for (size_t e = 0; e < CORPUS_EXPRESSIONS; ++e) {
+        vector<string> tokens;
+        generateTokens(40, true, (unsigned)e, [&](const string& token) { tokens.push_back(token); });
+        if (e % 2 == 1) {
+            vector<string> copy = tokens;
+            tokens.insert(tokens.end(), copy.begin(), copy.end());
+            tokens.push_back("*");
+        }
+        Program program;
+        compileRPN(tokens, program);
+        corpus.tokens.push_back(std::move(tokens));
+        corpus.programs.push_back(std::move(program));
+    }
+    mt19937 random(1);
+    corpus.bindings.resize(CORPUS_BINDINGS * VARIABLES);
+    for (int& value : corpus.bindings) {
+        value = (int)(1 + random() % 9) * (random() % 2 ? 1 : -1);
+    }
+    return corpus;
+}
+
+// Evaluates every program with every binding through run and returns the sum of the results, modulo 2^64
+template <typename Arith>
+uint64_t runCorpus(const vector<Program>& programs, const vector<typename Arith::Value>& bindings) {
+    Evaluator<Arith> evaluator;
+    typename Arith::Value result;
+    uint64_t checksum = 0;
+    for (const Program& program : programs) {
+        for (size_t row = 0; row < CORPUS_BINDINGS; ++row) {
+            if (evaluator.run(program, bindings.data() + row * VARIABLES, result) == Status::Ok) {
+                checksum += (uint64_t)result;
+            }
+        }
+    }
+    return checksum;
+}
+
+// run on the corpus as compiled and after optimize
+void benchOptimizer(JsonReport& report, const Corpus& corpus) {
+    vector<Program> optimized = corpus.programs;
+    size_t operations_before = 0;
+    size_t operations_after = 0;
+    for (Program& program : optimized) {
+        OptimizeStats stats;
+        if (!optimize(program, stats)) {
+            fprintf(stderr, "optimize rejected a program of the corpus\n");
+            exit(1);
+        }
+        operations_before += stats.operations_before;
+        operations_after += stats.operations_after;
+    }
+    double evaluations = (double)corpus.programs.size() * CORPUS_BINDINGS;
+    for (bool use_optimized : {false, true}) {
+        uint64_t checksum = 0;
+        Timing timing = measure(5, [&]() {
+            checksum = runCorpus<WrapArith>(use_optimized ? optimized : corpus.programs, corpus.bindings);
+        });
+        report.add(use_optimized ? "run_optimized" : "run_unoptimized",
+                   {{"evaluations", evaluations},
+                    {"operations", (double)(use_optimized ? operations_after : operations_before)},
+                    {"checksum", (double)checksum}},
+                   timing, {{"ns_per_evaluation", timing.best_seconds * 1e9 / evaluations}});
+    }
+}
+
+// The arithmetic of the original evaluateRPN as an Evaluator backend: int operations and a division that goes
+// through floor((double)a / b). The original overflowed as signed int; here + - * wrap so that it stays defined.
+struct DoubleFloorArith {
+    using Value = int;
+    static bool add(int a, int b, int& r) { return WrapArith::add(a, b, r); }
+    static bool sub(int a, int b, int& r) { return WrapArith::sub(a, b, r); }
+    static bool mul(int a, int b, int& r) { return WrapArith::mul(a, b, r); }
+    static bool div(int a, int b, int& r) {
+        r = (int)(long long)floor((double)a / b);
+        return true;
+    }
+};
+
+// Evaluates every program for all bindings at once through runBatch and returns the same sum as runCorpus
+template <typename Arith>
+uint64_t runCorpusBatch(const vector<Program>& programs, const vector<const typename Arith::Value*>& columns) {
+    Evaluator<Arith> evaluator;
+    vector<typename Arith::Value> results(CORPUS_BINDINGS);
+    vector<uint8_t> errors(CORPUS_BINDINGS);
+    uint64_t checksum = 0;
+    for (const Program& program : programs) {
+        evaluator.runBatch(program, columns.data(), CORPUS_BINDINGS, results.data(), errors.data());
+        for (size_t row = 0; row < CORPUS_BINDINGS; ++row) {
+            if (!errors[row]) {
+                checksum += (uint64_t)results[row];
+            }
+        }
+    }
+    return checksum;
+}
+
+// The corpus with one backend, evaluated row by row with run and in blocks of rows with runBatch
+template <typename Arith>
+void benchBackend(JsonReport& report, const string& name, const Corpus& corpus) {
+    using Value = typename Arith::Value;
+    vector<Value> bindings(corpus.bindings.begin(), corpus.bindings.end());
+    vector<Value> column_values(bindings.size());   // Variable i of all rows, then variable i + 1, ...
+    vector<const Value*> columns(VARIABLES);
+    for (size_t i = 0; i < VARIABLES; ++i) {
+        for (size_t row = 0; row < CORPUS_BINDINGS; ++row) {
+            column_values[i * CORPUS_BINDINGS + row] = bindings[row * VARIABLES + i];
+        }
+        columns[i] = column_values.data() + i * CORPUS_BINDINGS;
+    }
+    double evaluations = (double)corpus.programs.size() * CORPUS_BINDINGS;
+    for (bool batch : {false, true}) {
+        uint64_t checksum = 0;
+        Timing timing = measure(5, [&]() {
+            checksum = batch ? runCorpusBatch<Arith>(corpus.programs, columns)
+                             : runCorpus<Arith>(corpus.programs, bindings);
+        });
+        report.add((batch ? "batch_" : "run_") + name, {{"evaluations", evaluations}, {"checksum", (double)checksum}},
+                   timing, {{"ns_per_evaluation", timing.best_seconds * 1e9 / evaluations}});
+    }
+}
+
+// The corpus with each numeric backend. CheckedArith stops at an overflow, so its checksum differs.
+void benchBackends(JsonReport& report, const Corpus& corpus) {
+    benchBackend<WrapArith>(report, "wrap_int", corpus);
+    benchBackend<CheckedArith>(report, "checked_int64", corpus);
+    benchBackend<DoubleFloorArith>(report, "original_int_double", corpus);
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options(argc, argv);
+    JsonReport report("rpn");
+
+    vector<size_t> lengths = {100000, 1000000};
+    if (options.large) {
+        lengths.push_back(10000000);
+    }
+    for (bool with_variables : {false, true}) {
+        for (size_t tokens : lengths) {
+            TempFile input;
+            FILE* file = input.open();
+            generate(file, tokens, with_variables, (unsigned)tokens);
+            fclose(file);
+            Timing timing = measure(5, [&]() { runSolution(solution_main, input.path()); });
+            report.add(with_variables ? "expression_with_variables" : "expression",
+                       {{"tokens", (double)tokens}}, timing,
+                       {{"ns_per_token", timing.best_seconds * 1e9 / tokens},
+                        {"input_mb_per_s", input.size() / timing.best_seconds / 1e6}});
+        }
+    }
+
+    benchSplitters(report);
+
+    Corpus corpus = makeCorpus();
+    benchOptimizer(report, corpus);
+    benchBackends(report, corpus);
+
+    report.write(options.json);
+    return 0;
+}
@@ -0,0 +1,126 @@
+// Benchmark of Tasks_Sprint_2/A.cpp (matrix transposition).
+// The transpose kernels are timed on square matrices of 1024, 4096 (and with --large 16384) rows against the loop
+// of the original solution, and the whole program is timed on generated text input against the original program,
+// which reads with cin >> and prints with cout << and one endl per row.
+// Throughput counts every element once read and once written: 2 * 4 * n * m bytes.
+
+#define main solution_main
+#include "../Sprint_2_Basic data structures/Tasks_Sprint_2/A.cpp"
+#undef main
+
+#include "bench.h"
+
+#include <iostream>
+#include <random>
+
+double gigabytesPerSecond(size_t n, size_t m, const Timing& timing) {
+    return 2.0 * sizeof(int) * n * m / timing.best_seconds / 1e9;
+}
+
+int repetitionsFor(size_t n) {
+    return n <= 1024 ? 20 : n <= 4096 ? 5 : 2;
+}
+
+// The loop of the original solution: one vector per row, element by element
+void benchBaselineLoop(JsonReport& report, size_t n) {
+    vector<vector<int>> matrix(n, vector<int>(n));
+    vector<vector<int>> transposed(n, vector<int>(n));
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            matrix[i][j] = (int)(i * n + j);
+        }
+    }
+    Timing timing = measure(repetitionsFor(n), [&]() {
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                transposed[j][i] = matrix[i][j];
+            }
+        }
+    });
+    report.add("baseline_loop", {{"n", (double)n}, {"m", (double)n}}, timing,
+               {{"gb_per_s", gigabytesPerSecond(n, n, timing)}});
+}
+
+void benchKernels(JsonReport& report, size_t n) {
+    vector<int> src(n * n);
+    vector<int> dst(n * n);
+    for (size_t i = 0; i < src.size(); ++i) {
+        src[i] = (int)i;
+    }
+    Timing timing = measure(repetitionsFor(n), [&]() { transposeColumns(src.data(), n, n, 0, n, dst.data()); });
+    report.add("tiled", {{"n", (double)n}, {"m", (double)n}}, timing, {{"gb_per_s", gigabytesPerSecond(n, n, timing)}});
+    timing = measure(repetitionsFor(n), [&]() { transposeSquareInPlace(src.data(), n); });
+    report.add("tiled_in_place", {{"n", (double)n}, {"m", (double)n}}, timing,
+               {{"gb_per_s", gigabytesPerSecond(n, n, timing)}});
+}
+
+// The original solution: iostream input and output and one vector per row
+int originalProgram() {
+    int n, m;
+    cin >> n >> m;
+    vector<vector<int>> matrix(n, vector<int>(m));
+    vector<vector<int>> transposed(m, vector<int>(n));
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < m; ++j) {
+            cin >> matrix[i][j];
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < m; ++j) {
+            transposed[j][i] = matrix[i][j];
+        }
+    }
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < n; ++j) {
+            cout << transposed[i][j];
+            if (j < n - 1) {
+                cout << " ";
+            }
+        }
+        cout << endl;
+    }
+    return 0;
+}
+
+void benchProgram(JsonReport& report, size_t n, size_t m) {
+    TempFile input;
+    FILE* file = input.open();
+    mt19937 random(n * 1000 + m);
+    uniform_int_distribution<int> value(-1000000000, 1000000000);
+    fprintf(file, "%zu %zu\n", n, m);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            fprintf(file, j + 1 < m ? "%d " : "%d\n", value(random));
+        }
+    }
+    fclose(file);
+    for (bool original : {false, true}) {
+        Timing timing = measure(3, [&]() { runSolution(original ? originalProgram : solution_main, input.path()); });
+        report.add(original ? "program_iostream" : "program", {{"n", (double)n}, {"m", (double)m}}, timing,
+                   {{"input_mb_per_s", input.size() / timing.best_seconds / 1e6},
+                    {"ns_per_element", timing.best_seconds * 1e9 / (n * m)}});
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options(argc, argv);
+    JsonReport report("transpose");
+
+    vector<size_t> sizes = {1024, 4096};
+    if (options.large) {
+        sizes.push_back(16384);
+    }
+    for (size_t n : sizes) {
+        benchBaselineLoop(report, n);
+        benchKernels(report, n);
+    }
+
+    benchProgram(report, 2000, 2000);
+    benchProgram(report, 1000, 6000);
+    if (options.large) {
+        benchProgram(report, 4000, 4000);
+    }
+
+    report.write(options.json);
+    return 0;
+}
@@ -0,0 +1,136 @@
+// Tests of CircularDeque and InlineCircularDeque from Final_Tasks_2/A.cpp, whose main only runs the judge's command format.
+// The solution is included with its main renamed, so the templates are tested exactly as submitted.
+
+#define main solution_main
+#include "../Sprint_2_Basic data structures/Final_Tasks_2/A.cpp"
+#undef main
+
+#include <cassert>
+#include <deque>
+#include <random>
+#include <string>
+
+// Allocator that counts the allocations and the constructed elements that are still alive
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    static inline long live_allocations = 0;
+    static inline long live_elements = 0;
+
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        ++live_allocations;
+        return allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, size_t n) {
+        --live_allocations;
+        allocator<T>().deallocate(p, n);
+    }
+    template <typename... Args>
+    void construct(T* p, Args&&... args) {
+        ++live_elements;
+        new (p) T(std::forward<Args>(args)...);
+    }
+    void destroy(T* p) {
+        --live_elements;
+        p->~T();
+    }
+
+    bool operator==(const CountingAllocator&) const { return true; }
+    bool operator!=(const CountingAllocator&) const { return false; }
+};
+
+// Runs the same random operations on deque and on std::deque limited to m elements and compares every result.
+// Strings longer than the small-string buffer make a lost move or a missing destroy visible to the sanitizers.
+template <typename Deque>
+void compareWithStdDeque(Deque& deque, size_t m, size_t operations, unsigned seed) {
+    std::deque<string> expected;
+    mt19937 random(seed);
+    for (size_t i = 0; i < operations; ++i) {
+        int operation = (int)(random() % 4);
+        string value = "element number " + to_string(random());
+        string popped;
+        switch (operation) {
+        case 0:
+            assert(deque.push_back(value) == (expected.size() < m));
+            if (expected.size() < m) {
+                expected.push_back(value);
+            }
+            break;
+        case 1:
+            assert(deque.push_front(value) == (expected.size() < m));
+            if (expected.size() < m) {
+                expected.push_front(value);
+            }
+            break;
+        case 2:
+            assert(deque.pop_back(popped) == !expected.empty());
+            if (!expected.empty()) {
+                assert(popped == expected.back());
+                expected.pop_back();
+            }
+            break;
+        case 3:
+            assert(deque.pop_front(popped) == !expected.empty());
+            if (!expected.empty()) {
+                assert(popped == expected.front());
+                expected.pop_front();
+            }
+            break;
+        }
+        assert(deque.size() == expected.size());
+        assert(deque.empty() == expected.empty());
+    }
+}
+
+void testGrowthPolicies() {
+    using Alloc = CountingAllocator<string>;
+    for (Growth growth : {Growth::Fixed, Growth::Geometric}) {
+        for (size_t m : {1, 2, 15, 16, 17, 100, 1000}) {
+            {
+                CircularDeque<string, Alloc> deque(m, growth);
+                compareWithStdDeque(deque, m, 20000, (unsigned)m);
+                assert(Alloc::live_allocations == 1);   // A reallocation frees the old buffer
+            }
+            assert(Alloc::live_allocations == 0);
+            assert(Alloc::live_elements == 0);          // The destructor destroys what is left in the deque
+        }
+    }
+}
+
+// Fills a geometric deque from both ends so that every reallocation has to unwrap a buffer that wraps around
+void testGeometricReallocationKeepsOrder() {
+    CircularDeque<int> deque(1000, Growth::Geometric);
+    for (int i = 0; i < 500; ++i) {
+        assert(deque.push_front(-i));
+        assert(deque.push_back(i));
+    }
+    assert(!deque.push_back(0));    // The maximum size is still enforced after growing
+    int value;
+    for (int i = 499; i >= 0; --i) {
+        assert(deque.pop_front(value) && value == -i);
+    }
+    for (int i = 499; i >= 0; --i) {
+        assert(deque.pop_back(value) && value == i);
+    }
+    assert(!deque.pop_back(value));
+}
+
+// The inline deque must behave like the heap one for every maximum size up to its capacity
+void testInlineDeque() {
+    for (size_t m : {1, 2, 15, 16}) {
+        InlineCircularDeque<string, 16> deque(m);
+        compareWithStdDeque(deque, m, 20000, (unsigned)m);
+    }
+}
+
+int main() {
+    testGrowthPolicies();
+    testGeometricReallocationKeepsOrder();
+    testInlineDeque();
+    return 0;
+}
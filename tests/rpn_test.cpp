@@ -0,0 +1,251 @@
+// Tests of the RPN compiler and evaluator from Final_Tasks_2/B.cpp beyond what main exercises.
+// The solution is included with its main renamed, so the templates are tested exactly as submitted.
+
+#define main solution_main
+#include "../Sprint_2_Basic data structures/Final_Tasks_2/B.cpp"
+#undef main
+
+#include <cassert>
+#include <random>
+
+// A random valid expression with `operands` operands: the variables a, b, c, d and the numbers -3 ... 3,
+// so that divisions by zero are common
+vector<string> randomExpression(mt19937& random, size_t operands) {
+    vector<string> tokens;
+    size_t depth = 0;
+    size_t pushed = 0;
+    while (pushed < operands || depth > 1) {
+        if (depth >= 2 && (pushed == operands || random() % 2 == 0)) {
+            tokens.push_back(string(1, "+-*/"[random() % 4]));
+            --depth;
+        } else {
+            tokens.push_back(random() % 2 ? string(1, (char)('a' + random() % 4)) : to_string((int)(random() % 7) - 3));
+            ++depth;
+            ++pushed;
+        }
+    }
+    return tokens;
+}
+
+Program compile(const vector<string>& tokens) {
+    Program program;
+    bool valid = compileRPN(tokens, program);
+    assert(valid);
+    return program;
+}
+
+// runBatch over `rows` random rows must give every row the value and the error status of run
+template <typename Arith>
+void checkBatchAgainstRun(const Program& program, mt19937& random, size_t rows) {
+    using Value = typename Arith::Value;
+    size_t variables = program.variables.size();
+    vector<vector<Value>> columns(variables, vector<Value>(rows));
+    vector<const Value*> column_pointers;
+    for (vector<Value>& column : columns) {
+        for (Value& value : column) {
+            value = (Value)((int)(random() % 9) - 4);
+        }
+        column_pointers.push_back(column.data());
+    }
+    vector<Value> results(rows);
+    vector<uint8_t> errors(rows);
+    Evaluator<Arith> evaluator;
+    size_t failed = evaluator.runBatch(program, column_pointers.data(), rows, results.data(), errors.data());
+
+    size_t expected_failed = 0;
+    vector<Value> row(variables);
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t v = 0; v < variables; ++v) {
+            row[v] = columns[v][r];
+        }
+        Value expected;
+        bool ok = evaluator.run(program, row.data(), expected) == Status::Ok;
+        assert(errors[r] == !ok);
+        if (ok) {
+            assert(results[r] == expected);
+        }
+        expected_failed += !ok;
+    }
+    assert(failed == expected_failed);
+}
+
+void testRunBatch() {
+    mt19937 random(9);
+    for (int expression = 0; expression < 300; ++expression) {
+        Program program = compile(randomExpression(random, 1 + random() % 12));     // Includes single operands
+        for (size_t rows : {1, 255, 256, 257, 1000}) {      // Partial and full blocks
+            checkBatchAgainstRun<WrapArith>(program, random, rows);
+            checkBatchAgainstRun<CheckedArith>(program, random, rows);
+        }
+        OptimizeStats stats;
+        optimize(program, stats);       // Adds Tee and LoadTmp when a subexpression is shared
+        checkBatchAgainstRun<WrapArith>(program, random, 300);
+    }
+}
+
+// Both programs must give the same value or the same error for random variable values
+template <typename Arith>
+void checkSameResults(const Program& original, const Program& optimized, mt19937& random) {
+    using Value = typename Arith::Value;
+    Evaluator<Arith> evaluator;
+    vector<Value> vars(original.variables.size());
+    for (int trial = 0; trial < 20; ++trial) {
+        for (Value& value : vars) {
+            value = (Value)((int)(random() % 9) - 4);
+        }
+        Value expected = 0;
+        Value actual = 0;
+        Status expected_status = evaluator.run(original, vars.data(), expected);
+        Status actual_status = evaluator.run(optimized, vars.data(), actual);
+        assert(actual_status == expected_status);
+        if (expected_status == Status::Ok) {
+            assert(actual == expected);
+        }
+    }
+}
+
+void testOptimize() {
+    mt19937 random(11);
+    for (int expression = 0; expression < 3000; ++expression) {
+        vector<string> tokens = randomExpression(random, 1 + random() % 20);
+        if (expression % 2 == 0) {
+            vector<string> copy = tokens;
+            tokens.insert(tokens.end(), copy.begin(), copy.end());     // The same subexpression twice
+            tokens.push_back("*");
+        }
+        Program original = compile(tokens);
+        Program once = original;
+        OptimizeStats stats;
+        assert(optimize(once, stats));
+        assert(stats.operations_after <= stats.operations_before);
+        checkSameResults<WrapArith>(original, once, random);
+        checkSameResults<CheckedArith>(original, once, random);
+
+        // The output of optimize, with its Tee and LoadTmp, can be optimized again
+        Program twice = once;
+        assert(optimize(twice, stats));
+        assert(stats.operations_after <= stats.operations_before);
+        checkSameResults<WrapArith>(original, twice, random);
+        checkSameResults<CheckedArith>(original, twice, random);
+    }
+}
+
+void testOptimizeSharedSubexpression() {
+    Program program = compile({"x", "y", "+", "x", "y", "+", "*"});
+    OptimizeStats stats;
+    assert(optimize(program, stats));
+    assert(stats.operations_before == 3 && stats.operations_after == 2);
+    assert(program.temps == 1);
+    assert(optimize(program, stats));   // A second pass sees the shared node through Tee and LoadTmp
+    assert(stats.operations_before == 2 && stats.operations_after == 2);
+    int vars[] = {2, 5};
+    int result;
+    assert(Evaluator<>().run(program, vars, result) == Status::Ok && result == 49);
+}
+
+void testOptimizeRejectsInvalidPrograms() {
+    OptimizeStats stats;
+    Program empty;
+    assert(!optimize(empty, stats));
+
+    Program missing_operand;
+    missing_operand.code = {{Op::PushConst, 0}, {Op::Add, 0}};
+    missing_operand.constants = {1};
+    assert(!optimize(missing_operand, stats));
+    assert(missing_operand.code.size() == 2);   // Left unchanged
+
+    Program load_before_tee;
+    load_before_tee.code = {{Op::LoadTmp, 0}};
+    load_before_tee.temps = 1;
+    assert(!optimize(load_before_tee, stats));
+
+    Program unknown_temporary;
+    unknown_temporary.code = {{Op::PushConst, 0}, {Op::Tee, 3}};
+    unknown_temporary.constants = {1};
+    assert(!optimize(unknown_temporary, stats));
+
+    // compileRPN accepts values left under the result, and the division below the result still fails
+    Program leftover = compile({"1", "0", "/", "5"});
+    int result;
+    assert(Evaluator<>().run(leftover, nullptr, result) == Status::DivisionByZero);
+    assert(!optimize(leftover, stats));
+    assert(leftover.code.size() == 4);
+    assert(Evaluator<>().run(leftover, nullptr, result) == Status::DivisionByZero);
+}
+
+// Quotient rounded down, computed from a remainder with the sign of the divisor, in 128 bits
+__int128 referenceFloorDiv(__int128 a, __int128 b) {
+    __int128 remainder = a % b;
+    if (remainder != 0 && (remainder < 0) != (b < 0)) {
+        remainder += b;
+    }
+    return (a - remainder) / b;
+}
+
+void testCheckedArith() {
+    const int64_t EDGES[] = {INT64_MIN, INT64_MIN + 1, -3037000500LL, -7, -2, -1, 0, 1, 2, 7, 3037000500LL,
+                             INT64_MAX - 1, INT64_MAX};
+    vector<int64_t> values(begin(EDGES), end(EDGES));
+    mt19937_64 random(12);
+    for (int i = 0; i < 200; ++i) {
+        values.push_back((int64_t)random() >> (random() % 64));     // Random magnitudes of every width
+    }
+    for (int64_t a : values) {
+        for (int64_t b : values) {
+            __int128 exact[] = {(__int128)a + b, (__int128)a - b, (__int128)a * b,
+                                b != 0 ? referenceFloorDiv(a, b) : 0};
+            int64_t result[4] = {};
+            bool ok[] = {CheckedArith::add(a, b, result[0]), CheckedArith::sub(a, b, result[1]),
+                         CheckedArith::mul(a, b, result[2]), b != 0 && CheckedArith::div(a, b, result[3])};
+            for (int op = 0; op < 4; ++op) {
+                if (op == 3 && b == 0) {
+                    continue;   // Division by zero is caught by the evaluator before div is called
+                }
+                bool fits = exact[op] >= INT64_MIN && exact[op] <= INT64_MAX;
+                assert(ok[op] == fits);
+                if (fits) {
+                    assert(result[op] == exact[op]);
+                }
+            }
+            if (b != 0 && (a != INT64_MIN || b != -1)) {
+                assert(floorDiv(a, b) == referenceFloorDiv(a, b));
+            }
+        }
+    }
+}
+
+void testWrapArithDivision() {
+    int result;
+    WrapArith::div(INT_MIN, -1, result);
+    assert(result == INT_MIN);      // Wraps around instead of trapping
+    WrapArith::div(-7, 2, result);
+    assert(result == -4);
+    WrapArith::div(7, -2, result);
+    assert(result == -4);
+    WrapArith::div(-7, -2, result);
+    assert(result == 3);
+}
+
+void testEvaluatorReportsOverflow() {
+    Program program = compile({"2147483647", "2147483647", "*", "2147483647", "*"});
+    int64_t checked;
+    assert(Evaluator<CheckedArith>().run(program, nullptr, checked) == Status::Overflow);
+    int wrapped;
+    assert(Evaluator<WrapArith>().run(program, nullptr, wrapped) == Status::Ok);
+    assert(wrapped == (int)(2147483647u * 2147483647u * 2147483647u));
+
+    program = compile({"-2147483648", "2147483647", "*", "2", "*"});  // -2^63 + 2^32 still fits
+    assert(Evaluator<CheckedArith>().run(program, nullptr, checked) == Status::Ok);
+    assert(checked == -2147483648LL * 2147483647LL * 2);
+}
+
+int main() {
+    testRunBatch();
+    testOptimize();
+    testOptimizeSharedSubexpression();
+    testOptimizeRejectsInvalidPrograms();
+    testCheckedArith();
+    testWrapArithDivision();
+    testEvaluatorReportsOverflow();
+    return 0;
+}